@@ -0,0 +1,41 @@
+//
+// Description: Example of buffer slice usage.
+//
+
+/** C Includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+/** Smart Ptr Lib */
+#include <smemory/buf.h>
+
+int main(void)
+{
+      // Take ownership of a received message
+      char *data = malloc(32);
+      strcpy(data, "HEADERhello, world\n");
+      smemory_buf *message = smemory_buf_make(data, strlen(data), free);
+
+      // Split the header from the payload, no bytes are copied
+      smemory_buf *payload = smemory_buf_split(message, 6);
+
+      // Slice the payload into words
+      smemory_buf *hello = smemory_buf_slice(payload, 0, 7);
+      smemory_buf *world = smemory_buf_slice(payload, 7, smemory_buf_len(payload) - 7);
+
+      // Send the slices in reverse order with a single writev
+      smemory_buf_t *parts[] = { world, hello };
+      struct iovec iov[2];
+      smemory_buf_to_iovec(parts, 2, iov);
+      writev(STDOUT_FILENO, iov, 2);
+
+      // Adjacent slices of the same buffer join back without a copy
+      smemory_buf *joined = smemory_buf_concat(hello, world);
+      printf("%.*s", (int)smemory_buf_len(joined), (char *)smemory_buf_data(joined));
+
+      // The data is freed once the last slice goes out of scope
+      return 0;
+}
@@ -0,0 +1,43 @@
+//
+// Description: Example of persistent mempool usage.
+//              Run it several times: the counter survives restarts.
+//
+
+/** C Includes */
+#include <stdio.h>
+
+/** Smart Ptr Lib */
+#include <smemory/pmempool.h>
+
+typedef struct {
+      int runs;
+      char name[32];
+} cache_entry_t;
+
+int main(void)
+{
+      pmempool_t pool;
+
+      // Open the pool, creating it on the first run and starting over if the
+      // previous run crashed before closing it
+      if (pmempool_open(&pool, "pmempool_example.pool", sizeof(cache_entry_t), 64,
+                        PMEMPOOL_RESET_INVALID) != 0) {
+            perror("pmempool_open");
+            return 1;
+      }
+
+      // The root block is restored straight from the file, NULL if the pool is new
+      cache_entry_t *entry = pmempool_get_root(&pool);
+      if (entry == NULL) {
+            entry = pmempool_alloc(&pool);
+            entry->runs = 0;
+            snprintf(entry->name, sizeof(entry->name), "warm cache");
+            pmempool_set_root(&pool, entry);
+      }
+
+      entry->runs++;
+      printf("%s: run %d\n", entry->name, entry->runs);
+
+      pmempool_close(&pool);
+      return 0;
+}
@@ -0,0 +1,47 @@
+//
+// Description: Example of sampling heap profiler usage.
+//
+
+/** C Includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <unistd.h>
+
+/** Smart Ptr Lib */
+#include <smemory/mempool.h>
+#include <smemory/profiler.h>
+#include <smemory/unique_ptr.h>
+
+// Forgets to destroy the pointer it creates
+void leaky_function(void)
+{
+      unique_ptr_t *leak = unique_ptr_make(malloc(64), free);
+      (void)leak;
+}
+
+int main(void)
+{
+      // Sample every allocation (use e.g. 1000 in production)
+      smemory_profiler_start(1);
+
+      // `kill -USR1 <pid>` writes the live samples to a file
+      smemory_profiler_dump_on_signal(SIGUSR1, "smemory.folded");
+
+      mempool_t pool;
+      mempool_init(&pool, 128, 16);
+
+      for (int i = 0; i < 3; i++) {
+            // Released allocations drop their samples
+            unique_ptr *ok = unique_ptr_make(malloc(64), free);
+            mempool_free(&pool, mempool_alloc(&pool));
+
+            leaky_function();
+      }
+
+      // Only the three leaks are reported
+      smemory_profiler_dump(STDOUT_FILENO);
+
+      mempool_destroy(&pool);
+      return 0;
+}
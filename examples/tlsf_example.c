@@ -0,0 +1,34 @@
+//
+// Description: Example of TLSF allocator usage.
+//
+
+/** C Includes */
+#include <stdio.h>
+#include <string.h>
+
+/** Smart Ptr Lib */
+#include <smemory/tlsf.h>
+
+int main(void)
+{
+      // Manage a static region, no system allocator involved afterwards
+      static char region[64 * 1024];
+      tlsf_t tlsf;
+      tlsf_init(&tlsf, region, sizeof(region));
+
+      // Variable-size allocations in constant time
+      char *frame = tlsf_alloc(&tlsf, 480);
+      char *label = tlsf_alloc(&tlsf, 24);
+      strcpy(label, "telemetry");
+
+      tlsf_free(&tlsf, frame);
+
+      tlsf_stats_t stats;
+      tlsf_get_stats(&tlsf, &stats);
+      printf("%s: %zu bytes used in %zu blocks, %zu bytes free (fragmentation %.2f)\n",
+             label, stats.used_size, stats.used_count, stats.free_size, stats.fragmentation);
+
+      tlsf_free(&tlsf, label);
+      tlsf_destroy(&tlsf);
+      return 0;
+}
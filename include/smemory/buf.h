@@ -0,0 +1,171 @@
+/**
+ * @file buf.h
+ * @brief Reference counted buffer slices
+ *
+ * @date 18-10-2026
+ * @author JoaoAJMatos
+ */
+
+#ifndef SMEMORY_BUF_H
+#define SMEMORY_BUF_H
+
+#include <stddef.h>
+#include <sys/uio.h>
+
+#include "shared_ptr.h"
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+#define smemory_buf __attribute__((cleanup(smemory_buf_destroy))) smemory_buf_t
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Buffer slice structure
+ *
+ * @details A view of len bytes starting at ptr, inside a buffer whose lifetime
+ *          is held by owner, an aliasing shared pointer to ptr. Slicing,
+ *          splitting and concatenating never copy the bytes: the new slices
+ *          share the reference count of the underlying buffer, which is
+ *          released once the last slice is destroyed.
+ */
+typedef struct {
+    void *ptr;
+    size_t len;
+    shared_ptr_t *owner;
+} smemory_buf_t;
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/** CREATION FUNCTIONS */
+
+/**
+ * @brief Creates a buffer slice that takes ownership of a buffer
+ *
+ * @param data Pointer to the buffer
+ * @param len Length of the buffer in bytes
+ * @param destructor Pointer to the destructor function for data
+ * @return smemory_buf_t* Pointer to the new slice
+ */
+smemory_buf_t *smemory_buf_make(void *data, size_t len, destructor_t destructor);
+
+/**
+ * @brief Creates a buffer slice over memory owned by a shared pointer
+ *
+ * @param owner Pointer to the shared pointer owning the memory
+ * @param ptr Start of the slice, inside the memory owned by owner
+ * @param len Length of the slice in bytes
+ * @return smemory_buf_t* Pointer to the new slice
+ */
+smemory_buf_t *smemory_buf_from_shared(shared_ptr_t *owner, void *ptr, size_t len);
+
+/**
+ * @brief Creates a sub-slice of a buffer slice
+ *
+ * @param buf Pointer to the slice
+ * @param offset Offset of the sub-slice from the start of buf
+ * @param len Length of the sub-slice in bytes
+ * @return smemory_buf_t* Pointer to the new slice, NULL if out of range
+ */
+smemory_buf_t *smemory_buf_slice(smemory_buf_t *buf, size_t offset, size_t len);
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/** SPLIT AND CONCAT FUNCTIONS */
+
+/**
+ * @brief Splits a buffer slice in two
+ *
+ * @details buf is shortened to its first at bytes and the remaining bytes are
+ *          returned as a new slice
+ *
+ * @param buf Pointer to the slice to split
+ * @param at Split offset
+ * @return smemory_buf_t* Pointer to the tail slice, NULL if at is out of range
+ */
+smemory_buf_t *smemory_buf_split(smemory_buf_t *buf, size_t at);
+
+/**
+ * @brief Concatenates two buffer slices
+ *
+ * @details Only adjacent slices of the same buffer can be joined without a
+ *          copy. Use smemory_buf_to_iovec to gather unrelated slices.
+ *
+ * @param head Pointer to the first slice
+ * @param tail Pointer to the slice following head
+ * @return smemory_buf_t* Pointer to the joined slice, NULL if the slices are
+ *         not adjacent in the same buffer
+ */
+smemory_buf_t *smemory_buf_concat(smemory_buf_t *head, smemory_buf_t *tail);
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/** DESTRUCTION FUNCTIONS */
+
+/**
+ * @brief Destroys a buffer slice
+ *
+ * @param buf Pointer to the slice to destroy
+ */
+void smemory_buf_destroy(smemory_buf_t **buf);
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/** ACCESSOR FUNCTIONS */
+
+/**
+ * @brief Gets the start of a buffer slice
+ *
+ * @param buf Pointer to the slice
+ * @return void* Pointer to the first byte of the slice
+ */
+void *smemory_buf_data(smemory_buf_t *buf);
+
+/**
+ * @brief Gets the length of a buffer slice
+ *
+ * @param buf Pointer to the slice
+ * @return size_t Length of the slice in bytes
+ */
+size_t smemory_buf_len(smemory_buf_t *buf);
+
+/**
+ * @brief Describes buffer slices as an iovec array
+ *
+ * @details The result can be passed to writev to send the slices, or to
+ *          readv to fill them, without copying
+ *
+ * @param bufs Array of slices
+ * @param count Number of slices
+ * @param iov Array of at least count iovec entries to fill
+ * @return size_t Total length of the slices in bytes
+ */
+size_t smemory_buf_to_iovec(smemory_buf_t **bufs, size_t count, struct iovec *iov);
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SMEMORY_BUF_H
+
+
+
+// MIT License
+// 
+// Copyright (c) 2023 João Matos
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
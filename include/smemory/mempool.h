@@ -51,6 +51,17 @@ void mempool_destroy(mempool_t* mempool);
 void* mempool_alloc(mempool_t* mempool);
 
 
+/**
+ * @brief Allocates a block of memory only if the memory pool has one cached
+ *
+ * @details Unlike mempool_alloc, never falls back to malloc
+ *
+ * @param mempool Pointer to the memory pool
+ * @return void* Pointer to the allocated block, NULL if the pool is empty
+ */
+void* mempool_try_alloc(mempool_t* mempool);
+
+
 /**
  * @brief Frees a block of memory from the memory pool
  *
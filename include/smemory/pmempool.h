@@ -0,0 +1,197 @@
+/**
+ * @file pmempool.h
+ * @brief Persistent (file-backed) memory pool
+ *
+ * @details A fixed-size block pool whose slabs live in a memory-mapped file or
+ *          memfd. Blocks are addressed by offsets relative to the start of the
+ *          mapping, so a pool and its live objects survive a process restart
+ *          and are restored in O(1) by mapping the file again.
+ *
+ * @date 18-10-2026
+ * @author JoaoAJMatos
+ */
+
+#ifndef SMEMORY_PMEMPOOL_H
+#define SMEMORY_PMEMPOOL_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/** pmempool_open flag: replace an incompatible or uncleanly closed pool with an empty one */
+#define PMEMPOOL_RESET_INVALID 0x1
+
+/** Offset of a block from the start of the mapping. 0 is the null offset */
+typedef uint64_t pmempool_off_t;
+
+/**
+ * @brief On-disk header, stored at offset 0 of the mapping
+ *
+ * @details Free blocks are linked through their first 8 bytes. Blocks that
+ *          were never handed out are not on the free list; next_unused is a
+ *          bump index into them, so creating a pool does not touch its slabs.
+ */
+typedef struct pmempool_header {
+      uint64_t magic;
+      uint32_t version;
+      uint32_t clean;             /** Set on close, cleared while the pool is open */
+      uint64_t block_size;
+      uint64_t capacity;
+      uint64_t data_offset;       /** Offset of the first block */
+      pmempool_off_t free_head;
+      uint64_t next_unused;
+      uint64_t used;
+      pmempool_off_t root;        /** User entry point into the live objects */
+} pmempool_header_t;
+
+typedef struct pmempool {
+      int fd;
+      int owns_fd;
+      size_t map_size;
+      char *base;
+      pmempool_header_t *header;
+      pthread_mutex_t mutex;
+} pmempool_t;
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Opens or creates a persistent memory pool backed by a file
+ *
+ * @details If the file is empty it is sized and initialized with the given
+ *          block size and capacity. Otherwise the existing pool is mapped and
+ *          validated; block_size must then be 0 or match the stored one and
+ *          capacity is ignored.
+ *
+ *          With PMEMPOOL_RESET_INVALID, a file that would fail with EINVAL or
+ *          EIO is reinitialized as an empty pool instead. The root is then
+ *          NULL, which tells the caller to rebuild its contents.
+ *
+ * @param pmempool Pointer to the memory pool
+ * @param path Path of the backing file
+ * @param block_size Size of each block
+ * @param capacity Number of blocks
+ * @param flags 0 or PMEMPOOL_RESET_INVALID
+ * @return int 0 on success, -1 on failure with errno set (EINVAL if the file
+ *         holds an incompatible pool, EIO if it was not closed cleanly)
+ */
+int pmempool_open(pmempool_t* pmempool, const char* path, size_t block_size, size_t capacity, int flags);
+
+
+/**
+ * @brief Opens or creates a persistent memory pool on an open file descriptor
+ *
+ * @details Same as pmempool_open, for a descriptor such as one returned by
+ *          memfd_create. The descriptor stays owned by the caller.
+ *
+ * @param pmempool Pointer to the memory pool
+ * @param fd Read/write file descriptor
+ * @param block_size Size of each block
+ * @param capacity Number of blocks
+ * @param flags 0 or PMEMPOOL_RESET_INVALID
+ * @return int 0 on success, -1 on failure with errno set
+ */
+int pmempool_open_fd(pmempool_t* pmempool, int fd, size_t block_size, size_t capacity, int flags);
+
+
+/**
+ * @brief Flushes and closes a persistent memory pool
+ *
+ * @details Marks the pool as cleanly closed. Live blocks stay in the file.
+ *
+ * @param pmempool Pointer to the memory pool
+ */
+void pmempool_close(pmempool_t* pmempool);
+
+
+/**
+ * @brief Flushes the pool contents to the backing file
+ *
+ * @param pmempool Pointer to the memory pool
+ * @return int 0 on success, -1 on failure with errno set
+ */
+int pmempool_sync(pmempool_t* pmempool);
+
+
+/**
+ * @brief Allocates a block of memory from the memory pool
+ *
+ * @param pmempool Pointer to the memory pool
+ * @return void* Pointer to the allocated block, NULL if the pool is full
+ */
+void* pmempool_alloc(pmempool_t* pmempool);
+
+
+/**
+ * @brief Frees a block of memory from the memory pool
+ *
+ * @param pmempool Pointer to the memory pool
+ * @param ptr Pointer to the block to free
+ */
+void pmempool_free(pmempool_t* pmempool, void* ptr);
+
+
+/**
+ * @brief Converts a block pointer to its offset in the pool
+ *
+ * @param pmempool Pointer to the memory pool
+ * @param ptr Pointer into the pool, or NULL
+ * @return pmempool_off_t Offset of the pointer, 0 for NULL
+ */
+pmempool_off_t pmempool_offset(pmempool_t* pmempool, const void* ptr);
+
+
+/**
+ * @brief Converts an offset back to a pointer in the current mapping
+ *
+ * @param pmempool Pointer to the memory pool
+ * @param offset Offset returned by pmempool_offset
+ * @return void* Pointer to the block, NULL for the null offset
+ */
+void* pmempool_pointer(pmempool_t* pmempool, pmempool_off_t offset);
+
+
+/**
+ * @brief Sets the root object of the pool
+ *
+ * @param pmempool Pointer to the memory pool
+ * @param ptr Pointer to the root block, or NULL
+ */
+void pmempool_set_root(pmempool_t* pmempool, void* ptr);
+
+
+/**
+ * @brief Gets the root object of the pool
+ *
+ * @param pmempool Pointer to the memory pool
+ * @return void* Pointer to the root block, NULL if none was set
+ */
+void* pmempool_get_root(pmempool_t* pmempool);
+
+
+#endif //SMEMORY_PMEMPOOL_H
+
+
+// MIT License
+// 
+// Copyright (c) 2023 João Matos
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
@@ -0,0 +1,107 @@
+/**
+ * @file profiler.h
+ * @brief Sampling heap profiler for memory pools and smart pointers
+ *
+ * @details When started, roughly one in every sample_period allocations made
+ *          through mempool_alloc, unique_ptr_make, shared_ptr_make,
+ *          shared_ptr_copy and shared_ptr_alias records its backtrace. The
+ *          sample is dropped when the block or smart pointer is released, so
+ *          a dump lists the sampled allocations that are still alive.
+ *
+ *          Dumps use the folded stack format (one "root;...;leaf weight" line
+ *          per sample) understood by flamegraph.pl and speedscope. The weight
+ *          is the sample period in effect when the sample was taken, an
+ *          estimate of the live allocations each sample stands for.
+ *
+ *          smemory_profiler_dump names frames with dladdr, so executables
+ *          need to be linked with -rdynamic for their own symbols to show up.
+ *          Otherwise, and in signal-triggered dumps, frames appear as
+ *          "module+0xoffset", which addr2line can resolve.
+ *
+ * @date 18-10-2026
+ * @author JoaoAJMatos
+ */
+
+#ifndef SMEMORY_PROFILER_H
+#define SMEMORY_PROFILER_H
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/** Maximum number of live samples kept at once */
+#define SMEMORY_PROFILER_SLOTS 4096
+
+/** Maximum number of frames recorded per sample */
+#define SMEMORY_PROFILER_MAX_FRAMES 32
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Starts sampling allocations
+ *
+ * @param sample_period Average number of allocations between two samples
+ * @return int 0 on success, -1 if sample_period is 0
+ */
+int smemory_profiler_start(unsigned int sample_period);
+
+
+/**
+ * @brief Stops sampling allocations
+ *
+ * @details Samples already taken are kept, and still dropped on release,
+ *          so they can be dumped afterwards
+ */
+void smemory_profiler_stop(void);
+
+
+/**
+ * @brief Writes the live samples to a file descriptor
+ *
+ * @details Symbolizes frames with dladdr(3), which takes the dynamic
+ *          loader lock: do not call it from a signal handler, use
+ *          smemory_profiler_dump_on_signal instead
+ *
+ * @param fd File descriptor to write to
+ * @return int Number of samples written, -1 on write failure
+ */
+int smemory_profiler_dump(int fd);
+
+
+/**
+ * @brief Dumps the live samples to a file whenever a signal is received
+ *
+ * @details The handler only uses async-signal-safe calls. Frames are written
+ *          as "module+0xoffset" using the module list cached by this function
+ *          and smemory_profiler_start; modules loaded later appear as raw
+ *          addresses.
+ *
+ * @param signum Signal number, e.g. SIGUSR1
+ * @param path Path of the file to (re)write on each signal
+ * @return int 0 on success, -1 on failure
+ */
+int smemory_profiler_dump_on_signal(int signum, const char *path);
+
+
+#endif //SMEMORY_PROFILER_H
+
+
+// MIT License
+// 
+// Copyright (c) 2023 João Matos
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
@@ -34,9 +34,14 @@
  * 
  *          The default deleter for shared_ptr is a function object that calls
  *          delete on the pointer to the object.
+ *
+ *          An aliasing shared_ptr (see shared_ptr_alias) shares ownership of
+ *          the managed object but exposes a different pointer, typically a
+ *          member of, or a range inside, the managed object.
  */
 typedef struct {
     void *ptr;
+    void *managed;
     destructor_t destructor;
     int *ref_count;
 } shared_ptr_t;
@@ -54,6 +59,20 @@ typedef struct {
  */
 shared_ptr_t *shared_ptr_make(void *ptr, destructor_t destructor);
 
+/**
+ * @brief Creates a shared pointer that aliases another one
+ * 
+ * @details The new shared pointer shares the reference count and the managed
+ *          object of owner, but shared_ptr_get returns ptr. The managed object
+ *          stays alive until every shared pointer, aliasing or not, is
+ *          destroyed.
+ * 
+ * @param owner Pointer to the shared pointer whose ownership is shared
+ * @param ptr Pointer exposed by the new shared pointer
+ * @return shared_ptr_t* Pointer to the new shared pointer
+ */
+shared_ptr_t *shared_ptr_alias(shared_ptr_t *owner, void *ptr);
+
 /////////////////////////////////////////////////////////////////////////////////////
 
 /** COPY AND MOVE FUNCTIONS */
@@ -86,6 +105,9 @@ shared_ptr_t *shared_ptr_move(shared_ptr_t *ptr);
 /**
  * @brief Destroys a shared pointer
  * 
+ * @details Decrements the reference count and destroys the managed object
+ *          once it reaches zero
+ * 
  * @param ptr Pointer to the shared pointer to destroy
  */
 void shared_ptr_destroy(shared_ptr_t **ptr);
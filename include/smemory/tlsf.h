@@ -0,0 +1,158 @@
+/**
+ * @file tlsf.h
+ * @brief Two-Level Segregated Fit allocator
+ *
+ * @details Variable-size allocator with constant worst-case alloc and free
+ *          times, for code that cannot afford malloc's unbounded latency.
+ *          Free blocks are kept in segregated lists indexed by a first level
+ *          (power of two) and a second level (linear subdivision of it);
+ *          two bitmaps find a suitable non-empty list in O(1). Freed blocks
+ *          are immediately coalesced with their free neighbours.
+ *
+ *          Each allocator is guarded by a priority-inheritance mutex. A region
+ *          mapped by tlsf_init is prefaulted and, when RLIMIT_MEMLOCK allows
+ *          it, locked in memory; caller-provided regions should be touched
+ *          (or mlock'd) beforehand for the latency bound to hold.
+ *
+ * @date 18-10-2026
+ * @author JoaoAJMatos
+ */
+
+#ifndef SMEMORY_TLSF_H
+#define SMEMORY_TLSF_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/** Second level subdivisions per first level (log2) */
+#define TLSF_SL_INDEX_COUNT_LOG2 5
+#define TLSF_SL_INDEX_COUNT (1 << TLSF_SL_INDEX_COUNT_LOG2)
+
+/** First level classes, enough for blocks up to 1 TiB */
+#define TLSF_FL_INDEX_COUNT 32
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+struct tlsf_block;
+
+typedef struct tlsf {
+      void *memory;
+      size_t size;
+      int owns_memory;
+
+      uint32_t fl_bitmap;
+      uint32_t sl_bitmap[TLSF_FL_INDEX_COUNT];
+      struct tlsf_block *blocks[TLSF_FL_INDEX_COUNT][TLSF_SL_INDEX_COUNT];
+
+      size_t used_size;
+      size_t used_count;
+      size_t peak_used_size;
+      size_t free_size;
+      size_t free_count;
+
+      pthread_mutex_t mutex;
+} tlsf_t;
+
+typedef struct tlsf_stats {
+      size_t total_size;          /** Bytes of the region, including block headers */
+      size_t used_size;           /** Bytes handed out, rounded to the block granularity */
+      size_t used_count;          /** Number of allocated blocks */
+      size_t peak_used_size;      /** Highest used_size since initialization */
+      size_t free_size;           /** Bytes available in free blocks */
+      size_t free_count;          /** Number of free blocks */
+      size_t max_alloc_size;      /** Largest request tlsf_alloc can currently serve */
+      double fragmentation;       /** 1 - max_alloc_size / free_size, 0 when nothing is free */
+} tlsf_stats_t;
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Initializes a TLSF allocator over a memory region
+ *
+ * @param tlsf Pointer to the allocator
+ * @param memory Region to manage, or NULL to map (and prefault) size bytes
+ * @param size Size of the region in bytes
+ * @return int 0 on success, -1 if the region is too small, too large or
+ *         could not be mapped
+ */
+int tlsf_init(tlsf_t* tlsf, void* memory, size_t size);
+
+
+/**
+ * @brief Cleans up a TLSF allocator
+ *
+ * @details Unmaps the region if it was mapped by tlsf_init. A caller-provided
+ *          region is left untouched.
+ *
+ * @param tlsf Pointer to the allocator
+ */
+void tlsf_destroy(tlsf_t* tlsf);
+
+
+/**
+ * @brief Allocates a block of memory in constant time
+ *
+ * @param tlsf Pointer to the allocator
+ * @param size Size of the block, the returned pointer is 16-byte aligned
+ * @return void* Pointer to the allocated block, NULL if no free block is large enough
+ */
+void* tlsf_alloc(tlsf_t* tlsf, size_t size);
+
+
+/**
+ * @brief Frees a block of memory in constant time
+ *
+ * @param tlsf Pointer to the allocator
+ * @param ptr Pointer to the block to free
+ */
+void tlsf_free(tlsf_t* tlsf, void* ptr);
+
+
+/**
+ * @brief Gets the usable size of an allocated block
+ *
+ * @param ptr Pointer to the block
+ * @return size_t Usable size of the block in bytes
+ */
+size_t tlsf_block_size(void* ptr);
+
+
+/**
+ * @brief Gets usage and fragmentation statistics
+ *
+ * @details Runs in constant time under the allocator lock, so it can be
+ *          called alongside real-time users of the allocator
+ *
+ * @param tlsf Pointer to the allocator
+ * @param stats Pointer to the statistics to fill
+ */
+void tlsf_get_stats(tlsf_t* tlsf, tlsf_stats_t* stats);
+
+
+#endif //SMEMORY_TLSF_H
+
+
+// MIT License
+// 
+// Copyright (c) 2023 João Matos
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
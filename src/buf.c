@@ -0,0 +1,144 @@
+//
+// Created by JoaoAJMatos on 18-10-2026.
+//
+
+/** C Includes */
+#include <stdlib.h>
+
+/** Lib Includes */
+#include <smemory/buf.h>
+
+
+/** Constructs a slice over a shared owner without taking a new reference */
+static smemory_buf_t *smemory_buf_wrap(shared_ptr_t *owner, void *ptr, size_t len)
+{
+      if (owner == NULL) return NULL;
+
+      smemory_buf_t *_buf = malloc(sizeof(smemory_buf_t));
+      if (_buf == NULL) {
+            shared_ptr_destroy(&owner);
+            return NULL;
+      }
+
+      _buf->ptr = ptr;
+      _buf->len = len;
+      _buf->owner = owner;
+      return _buf;
+}
+
+
+/** Constructs a slice owning a whole buffer */
+smemory_buf_t *smemory_buf_make(void *data, size_t len, destructor_t destructor)
+{
+      return smemory_buf_wrap(shared_ptr_make(data, destructor), data, len);
+}
+
+
+/** Constructs a slice of memory owned by a shared_ptr */
+smemory_buf_t *smemory_buf_from_shared(shared_ptr_t *owner, void *ptr, size_t len)
+{
+      if (owner == NULL) return NULL;
+      return smemory_buf_wrap(shared_ptr_alias(owner, ptr), ptr, len);
+}
+
+
+/** Constructs a sub-slice */
+smemory_buf_t *smemory_buf_slice(smemory_buf_t *buf, size_t offset, size_t len)
+{
+      if (buf == NULL) return NULL;
+      if (offset > buf->len || len > buf->len - offset) return NULL;
+
+      char *ptr = (char *)buf->ptr + offset;
+      return smemory_buf_wrap(shared_ptr_alias(buf->owner, ptr), ptr, len);
+}
+
+
+/** Splits a slice at the given offset, returning the tail */
+smemory_buf_t *smemory_buf_split(smemory_buf_t *buf, size_t at)
+{
+      if (buf == NULL) return NULL;
+
+      smemory_buf_t *tail = smemory_buf_slice(buf, at, buf->len - at);
+      if (tail == NULL) return NULL;
+
+      buf->len = at;
+      return tail;
+}
+
+
+/** Joins two adjacent slices of the same buffer */
+smemory_buf_t *smemory_buf_concat(smemory_buf_t *head, smemory_buf_t *tail)
+{
+      if (head == NULL || tail == NULL) return NULL;
+      if (head->owner->ref_count != tail->owner->ref_count) return NULL;
+      if ((char *)head->ptr + head->len != (char *)tail->ptr) return NULL;
+
+      return smemory_buf_wrap(shared_ptr_alias(head->owner, head->ptr), head->ptr, head->len + tail->len);
+}
+
+
+/** Destroys a slice */
+void smemory_buf_destroy(smemory_buf_t **buf)
+{
+      if (buf == NULL) return;
+      if (*buf == NULL) return;
+
+      shared_ptr_destroy(&(*buf)->owner);
+      free(*buf);
+      *buf = NULL;
+}
+
+
+/** Gets the start of a slice */
+void *smemory_buf_data(smemory_buf_t *buf)
+{
+      if (buf == NULL) return NULL;
+      return buf->ptr;
+}
+
+
+/** Gets the length of a slice */
+size_t smemory_buf_len(smemory_buf_t *buf)
+{
+      if (buf == NULL) return 0;
+      return buf->len;
+}
+
+
+/** Fills an iovec array from slices */
+size_t smemory_buf_to_iovec(smemory_buf_t **bufs, size_t count, struct iovec *iov)
+{
+      size_t total = 0;
+
+      for (size_t i = 0; i < count; i++) {
+            iov[i].iov_base = bufs[i]->ptr;
+            iov[i].iov_len = bufs[i]->len;
+            total += bufs[i]->len;
+      }
+
+      return total;
+}
+
+
+
+// MIT License
+// 
+// Copyright (c) 2023 João Matos
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
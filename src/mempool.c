@@ -4,6 +4,7 @@
 
 /** Lib Includes */
 #include <smemory/mempool.h>
+#include "profiler_hooks.h"
 
 
 /** Inits a mempool */
@@ -38,6 +39,7 @@ void* mempool_alloc(mempool_t* mempool)
       if (mempool->count == 0) {
             void *block = malloc(mempool->block_size);
             pthread_mutex_unlock(&mempool->mutex);
+            smemory_profiler_on_alloc(block, "mempool_alloc");
             return block;
       }
 
@@ -46,6 +48,26 @@ void* mempool_alloc(mempool_t* mempool)
       mempool->count--;
 
       pthread_mutex_unlock(&mempool->mutex);
+      smemory_profiler_on_alloc(block, "mempool_alloc");
+      return block;
+}
+
+
+/** Allocates a cached block, without falling back to malloc */
+void* mempool_try_alloc(mempool_t* mempool)
+{
+      pthread_mutex_lock(&mempool->mutex);
+
+      if (mempool->count == 0) {
+            pthread_mutex_unlock(&mempool->mutex);
+            return NULL;
+      }
+
+      void *block = mempool->blocks[mempool->count - 1];
+      mempool->count--;
+
+      pthread_mutex_unlock(&mempool->mutex);
+      smemory_profiler_on_alloc(block, "mempool_alloc");
       return block;
 }
 
@@ -53,6 +75,8 @@ void* mempool_alloc(mempool_t* mempool)
 /** Frees a block of memory */
 void mempool_free(mempool_t* mempool, void* block)
 {
+      smemory_profiler_on_release(block);
+
       pthread_mutex_lock(&mempool->mutex);
 
       if (mempool->count < mempool->capacity) {
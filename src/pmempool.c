@@ -0,0 +1,314 @@
+//
+// Created by JoaoAJMatos on 18-10-2026.
+//
+
+#define _POSIX_C_SOURCE 200809L
+
+/** C Includes */
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/** Lib Includes */
+#include <smemory/pmempool.h>
+
+
+#define PMEMPOOL_MAGIC   0x4c4f4f504d454d53ULL  /** "SMEMPOOL" */
+#define PMEMPOOL_VERSION 1
+#define PMEMPOOL_ALIGN   16
+
+
+/** Rounds size up to a multiple of align (a power of two) */
+static size_t pmempool_align_up(size_t size, size_t align)
+{
+      return (size + align - 1) & ~(align - 1);
+}
+
+
+/** Whether offset is 0 or the start of a block handed out at least once */
+static int pmempool_offset_valid(const pmempool_header_t *header, pmempool_off_t offset)
+{
+      if (offset == 0) return 1;
+      if (offset < header->data_offset) return 0;
+
+      uint64_t relative = offset - header->data_offset;
+      return relative % header->block_size == 0
+             && relative / header->block_size < header->next_unused;
+}
+
+
+/** Checks that a stored header describes a pool that fits in the file */
+static int pmempool_header_valid(const pmempool_header_t *header, uint64_t file_size, size_t block_size)
+{
+      uint64_t page_size = (uint64_t)sysconf(_SC_PAGESIZE);
+
+      if (header->magic != PMEMPOOL_MAGIC || header->version != PMEMPOOL_VERSION) return 0;
+      if (block_size != 0 && pmempool_align_up(block_size, PMEMPOOL_ALIGN) != header->block_size) return 0;
+
+      if (header->block_size == 0 || header->block_size % PMEMPOOL_ALIGN != 0) return 0;
+      if (header->data_offset < sizeof(pmempool_header_t) || header->data_offset % page_size != 0) return 0;
+
+      /** Overflow-safe form of data_offset + capacity * block_size <= file_size */
+      if (header->data_offset > file_size) return 0;
+      if (header->capacity == 0 || header->capacity > (file_size - header->data_offset) / header->block_size) return 0;
+      if (file_size > SIZE_MAX) return 0;
+
+      if (header->next_unused > header->capacity || header->used > header->next_unused) return 0;
+
+      return pmempool_offset_valid(header, header->free_head) && pmempool_offset_valid(header, header->root);
+}
+
+
+/** Maps the whole file and marks the pool as in use */
+static int pmempool_map(pmempool_t* pmempool, int fd, size_t map_size)
+{
+      void *base = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if (base == MAP_FAILED) return -1;
+
+      pmempool->fd = fd;
+      pmempool->map_size = map_size;
+      pmempool->base = base;
+      pmempool->header = base;
+      pthread_mutex_init(&pmempool->mutex, NULL);
+      return 0;
+}
+
+
+/** Checks an existing pool file, returning 0, EINVAL (incompatible) or EIO (not closed cleanly) */
+static int pmempool_check(int fd, uint64_t file_size, size_t block_size)
+{
+      pmempool_header_t header;
+      if (pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)
+          || !pmempool_header_valid(&header, file_size, block_size)) {
+            return EINVAL;
+      }
+
+      return header.clean ? 0 : EIO;
+}
+
+
+/** Maps a valid existing pool and marks it as in use */
+static int pmempool_attach(pmempool_t* pmempool, int fd, size_t file_size)
+{
+      if (pmempool_map(pmempool, fd, file_size) != 0) return -1;
+
+      /** The cleared marker must be on disk before any data page changes */
+      pmempool->header->clean = 0;
+      if (msync(pmempool->base, pmempool->header->data_offset, MS_SYNC) != 0) {
+            int error = errno;
+            munmap(pmempool->base, pmempool->map_size);
+            pthread_mutex_destroy(&pmempool->mutex);
+            errno = error;
+            return -1;
+      }
+
+      return 0;
+}
+
+
+/** Opens a pool on a file descriptor */
+int pmempool_open_fd(pmempool_t* pmempool, int fd, size_t block_size, size_t capacity, int flags)
+{
+      struct stat st;
+      if (fstat(fd, &st) != 0) return -1;
+
+      pmempool->owns_fd = 0;
+
+      /** Existing pool: validate the header and map it as is */
+      if (st.st_size > 0) {
+            int error = pmempool_check(fd, (uint64_t)st.st_size, block_size);
+            if (error == 0) return pmempool_attach(pmempool, fd, (size_t)st.st_size);
+
+            if (!(flags & PMEMPOOL_RESET_INVALID)) {
+                  errno = error;
+                  return -1;
+            }
+
+            /** Discard the unusable contents and create a fresh pool below */
+            if (ftruncate(fd, 0) != 0) return -1;
+      }
+
+      /** New pool: size the file and write a fresh header */
+      if (block_size == 0 || capacity == 0) {
+            errno = EINVAL;
+            return -1;
+      }
+
+      block_size = pmempool_align_up(block_size, PMEMPOOL_ALIGN);
+      size_t data_offset = pmempool_align_up(sizeof(pmempool_header_t), (size_t)sysconf(_SC_PAGESIZE));
+      if (capacity > (SIZE_MAX - data_offset) / block_size) {
+            errno = EINVAL;
+            return -1;
+      }
+
+      size_t map_size = data_offset + capacity * block_size;
+      if (ftruncate(fd, (off_t)map_size) != 0) return -1;
+      if (pmempool_map(pmempool, fd, map_size) != 0) return -1;
+
+      pmempool_header_t *header = pmempool->header;
+      header->version = PMEMPOOL_VERSION;
+      header->clean = 0;
+      header->block_size = block_size;
+      header->capacity = capacity;
+      header->data_offset = data_offset;
+      header->free_head = 0;
+      header->next_unused = 0;
+      header->used = 0;
+      header->root = 0;
+
+      /** The magic goes last so a half-initialized file is never accepted */
+      msync(pmempool->base, data_offset, MS_SYNC);
+      header->magic = PMEMPOOL_MAGIC;
+      return 0;
+}
+
+
+/** Opens a pool on a file path */
+int pmempool_open(pmempool_t* pmempool, const char* path, size_t block_size, size_t capacity, int flags)
+{
+      int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+      if (fd < 0) return -1;
+
+      if (pmempool_open_fd(pmempool, fd, block_size, capacity, flags) != 0) {
+            int error = errno;
+            close(fd);
+            errno = error;
+            return -1;
+      }
+
+      pmempool->owns_fd = 1;
+      return 0;
+}
+
+
+/** Flushes the mapping to the backing file */
+int pmempool_sync(pmempool_t* pmempool)
+{
+      return msync(pmempool->base, pmempool->map_size, MS_SYNC);
+}
+
+
+/** Closes a pool, leaving its contents in the file */
+void pmempool_close(pmempool_t* pmempool)
+{
+      pthread_mutex_lock(&pmempool->mutex);
+
+      /** Data must reach the file before the clean marker does */
+      msync(pmempool->base, pmempool->map_size, MS_SYNC);
+      pmempool->header->clean = 1;
+      msync(pmempool->base, pmempool->header->data_offset, MS_SYNC);
+
+      munmap(pmempool->base, pmempool->map_size);
+      if (pmempool->owns_fd) close(pmempool->fd);
+
+      pmempool->base = NULL;
+      pmempool->header = NULL;
+      pthread_mutex_unlock(&pmempool->mutex);
+      pthread_mutex_destroy(&pmempool->mutex);
+}
+
+
+/** Allocates a block from the pool */
+void* pmempool_alloc(pmempool_t* pmempool)
+{
+      pthread_mutex_lock(&pmempool->mutex);
+
+      pmempool_header_t *header = pmempool->header;
+      void *block = NULL;
+
+      if (header->free_head != 0) {
+            /** Reuse the most recently freed block */
+            block = pmempool->base + header->free_head;
+            memcpy(&header->free_head, block, sizeof(pmempool_off_t));
+
+            /** A corrupt link ends the free list rather than pointing outside the pool */
+            if (!pmempool_offset_valid(header, header->free_head)) header->free_head = 0;
+      } else if (header->next_unused < header->capacity) {
+            /** Hand out a block that was never used */
+            block = pmempool->base + header->data_offset + header->next_unused * header->block_size;
+            header->next_unused++;
+      }
+
+      if (block != NULL) header->used++;
+
+      pthread_mutex_unlock(&pmempool->mutex);
+      return block;
+}
+
+
+/** Returns a block to the pool */
+void pmempool_free(pmempool_t* pmempool, void* ptr)
+{
+      if (ptr == NULL) return;
+
+      pthread_mutex_lock(&pmempool->mutex);
+
+      pmempool_header_t *header = pmempool->header;
+      memcpy(ptr, &header->free_head, sizeof(pmempool_off_t));
+      header->free_head = (pmempool_off_t)((char *)ptr - pmempool->base);
+      header->used--;
+
+      pthread_mutex_unlock(&pmempool->mutex);
+}
+
+
+/** Pointer to offset */
+pmempool_off_t pmempool_offset(pmempool_t* pmempool, const void* ptr)
+{
+      if (ptr == NULL) return 0;
+      return (pmempool_off_t)((const char *)ptr - pmempool->base);
+}
+
+
+/** Offset to pointer */
+void* pmempool_pointer(pmempool_t* pmempool, pmempool_off_t offset)
+{
+      if (offset == 0) return NULL;
+      return pmempool->base + offset;
+}
+
+
+/** Sets the root object */
+void pmempool_set_root(pmempool_t* pmempool, void* ptr)
+{
+      pthread_mutex_lock(&pmempool->mutex);
+      pmempool->header->root = pmempool_offset(pmempool, ptr);
+      pthread_mutex_unlock(&pmempool->mutex);
+}
+
+
+/** Gets the root object */
+void* pmempool_get_root(pmempool_t* pmempool)
+{
+      pthread_mutex_lock(&pmempool->mutex);
+      void *root = pmempool_pointer(pmempool, pmempool->header->root);
+      pthread_mutex_unlock(&pmempool->mutex);
+      return root;
+}
+
+
+// MIT License
+// 
+// Copyright (c) 2023 João Matos
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
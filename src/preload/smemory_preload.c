@@ -0,0 +1,353 @@
+//
+// Created by JoaoAJMatos on 18-10-2026.
+//
+// Description: LD_PRELOAD malloc interposition shim. Small requests are
+//              served from mempool-backed size classes, everything else
+//              (large sizes, strict alignments, foreign pointers) falls
+//              through to the system allocator.
+//
+// Usage: LD_PRELOAD=/path/to/libsmemory_preload.so ./program
+//
+
+#define _GNU_SOURCE
+
+/** C Includes */
+#include <dlfcn.h>
+#include <errno.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+
+/** Lib Includes */
+#include <smemory/mempool.h>
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/** Smallest and largest size class, both powers of two */
+#define PRELOAD_MIN_CLASS_SHIFT 4
+#define PRELOAD_MAX_CLASS_SHIFT 10
+#define PRELOAD_NUM_CLASSES (PRELOAD_MAX_CLASS_SHIFT - PRELOAD_MIN_CLASS_SHIFT + 1)
+#define PRELOAD_MAX_SIZE ((size_t)1 << PRELOAD_MAX_CLASS_SHIFT)
+
+/** Virtual address space reserved per size class */
+#define PRELOAD_REGION_SIZE ((size_t)64 << 20)
+
+/** Free lists per size class, picked by CPU so threads rarely share a lock */
+#define PRELOAD_SHARDS 16
+
+/** Initial capacity of each shard free list */
+#define PRELOAD_POOL_CAPACITY 256
+
+/** Only the interposed allocator entry points are exported */
+#define PRELOAD_EXPORT __attribute__((visibility("default")))
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/** System allocator entry points (glibc) */
+extern void *__libc_malloc(size_t size);
+extern void  __libc_free(void *ptr);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void *__libc_memalign(size_t alignment, size_t size);
+
+enum { PRELOAD_UNINIT = 0, PRELOAD_INITIALIZING, PRELOAD_READY, PRELOAD_FAILED };
+
+typedef struct {
+      size_t block_size;
+      mempool_t shards[PRELOAD_SHARDS];
+      _Atomic size_t cursor;  /** Bump offset into the class region */
+} size_class_t;
+
+static _Atomic int state = PRELOAD_UNINIT;
+static char *arena = NULL;
+static size_class_t classes[PRELOAD_NUM_CLASSES];
+
+/**
+ * Set while the shim itself (or mempool on its behalf) is allocating, so that
+ * the nested malloc/realloc/free calls go straight to the system allocator.
+ */
+static __thread int in_shim __attribute__((tls_model("initial-exec")));
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/** Keeps the class mutexes consistent across fork() */
+static void preload_atfork_prepare(void)
+{
+      for (size_t i = 0; i < PRELOAD_NUM_CLASSES; i++) {
+            for (size_t j = 0; j < PRELOAD_SHARDS; j++) {
+                  pthread_mutex_lock(&classes[i].shards[j].mutex);
+            }
+      }
+}
+
+static void preload_atfork_release(void)
+{
+      for (size_t i = PRELOAD_NUM_CLASSES; i > 0; i--) {
+            for (size_t j = PRELOAD_SHARDS; j > 0; j--) {
+                  pthread_mutex_unlock(&classes[i - 1].shards[j - 1].mutex);
+            }
+      }
+}
+
+
+/** Maps the class regions and sets up the mempool shards of each size class */
+static void preload_init(void)
+{
+      int expected = PRELOAD_UNINIT;
+      if (!atomic_compare_exchange_strong(&state, &expected, PRELOAD_INITIALIZING)) return;
+
+      in_shim = 1;
+
+      void *region = mmap(NULL, PRELOAD_REGION_SIZE * PRELOAD_NUM_CLASSES,
+                          PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+      if (region == MAP_FAILED) {
+            in_shim = 0;
+            atomic_store(&state, PRELOAD_FAILED);
+            return;
+      }
+
+      arena = region;
+      for (size_t i = 0; i < PRELOAD_NUM_CLASSES; i++) {
+            classes[i].block_size = (size_t)1 << (i + PRELOAD_MIN_CLASS_SHIFT);
+            for (size_t j = 0; j < PRELOAD_SHARDS; j++) {
+                  mempool_init(&classes[i].shards[j], classes[i].block_size, PRELOAD_POOL_CAPACITY);
+            }
+            atomic_init(&classes[i].cursor, 0);
+      }
+      pthread_atfork(preload_atfork_prepare, preload_atfork_release, preload_atfork_release);
+
+      in_shim = 0;
+      atomic_store(&state, PRELOAD_READY);
+}
+
+
+/** Returns non-zero once the pools can serve requests from this thread */
+static inline int preload_ready(void)
+{
+      if (in_shim) return 0;
+      if (atomic_load_explicit(&state, memory_order_acquire) == PRELOAD_READY) return 1;
+      preload_init();
+      return atomic_load_explicit(&state, memory_order_acquire) == PRELOAD_READY;
+}
+
+
+/** Whether ptr was handed out by one of the size classes */
+static inline int preload_owns(const void *ptr)
+{
+      return arena != NULL
+             && (const char *)ptr >= arena
+             && (const char *)ptr < arena + PRELOAD_REGION_SIZE * PRELOAD_NUM_CLASSES;
+}
+
+
+/** Size class index for a request, or -1 if it is too large */
+static inline int preload_class_of_size(size_t size)
+{
+      if (size > PRELOAD_MAX_SIZE) return -1;
+
+      int index = 0;
+      size_t class_size = (size_t)1 << PRELOAD_MIN_CLASS_SHIFT;
+      while (class_size < size) {
+            class_size <<= 1;
+            index++;
+      }
+      return index;
+}
+
+
+/** Size class index of a pointer owned by the shim */
+static inline int preload_class_of_ptr(const void *ptr)
+{
+      return (int)(((const char *)ptr - arena) / PRELOAD_REGION_SIZE);
+}
+
+
+/** Shard of the CPU the calling thread runs on */
+static inline size_t preload_shard(void)
+{
+      int cpu = sched_getcpu();
+      return cpu < 0 ? 0 : (size_t)cpu % PRELOAD_SHARDS;
+}
+
+
+/** Allocates a block from a size class */
+static void *preload_class_alloc(int index)
+{
+      size_class_t *sc = &classes[index];
+      size_t shard = preload_shard();
+
+      /**
+       * Recycled blocks come from this CPU's mempool shard; when it is empty,
+       * carve a fresh block from the class region, and once the region is
+       * exhausted take a block cached by another shard. mempool_try_alloc
+       * never falls back to malloc, so every block honours the class alignment.
+       */
+      void *block = mempool_try_alloc(&sc->shards[shard]);
+      if (block != NULL) return block;
+
+      size_t offset = atomic_fetch_add(&sc->cursor, sc->block_size);
+      if (offset + sc->block_size <= PRELOAD_REGION_SIZE) {
+            return arena + (size_t)index * PRELOAD_REGION_SIZE + offset;
+      }
+
+      for (size_t i = 1; i < PRELOAD_SHARDS; i++) {
+            block = mempool_try_alloc(&sc->shards[(shard + i) % PRELOAD_SHARDS]);
+            if (block != NULL) return block;
+      }
+
+      return NULL;
+}
+
+
+/** Returns a block to the current CPU's shard of its size class */
+static void preload_class_free(void *ptr)
+{
+      /** Only reachable if mempool could not grow its free list; leak the block */
+      if (in_shim) return;
+
+      in_shim = 1;
+      mempool_free(&classes[preload_class_of_ptr(ptr)].shards[preload_shard()], ptr);
+      in_shim = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/** Interposed malloc */
+PRELOAD_EXPORT void *malloc(size_t size)
+{
+      if (preload_ready()) {
+            int index = preload_class_of_size(size);
+            if (index >= 0) {
+                  void *block = preload_class_alloc(index);
+                  if (block != NULL) return block;
+            }
+      }
+      return __libc_malloc(size);
+}
+
+
+/** Interposed free */
+PRELOAD_EXPORT void free(void *ptr)
+{
+      if (ptr == NULL) return;
+
+      if (preload_owns(ptr)) {
+            preload_class_free(ptr);
+            return;
+      }
+      __libc_free(ptr);
+}
+
+
+/** Interposed calloc */
+PRELOAD_EXPORT void *calloc(size_t nmemb, size_t size)
+{
+      if (size != 0 && nmemb > SIZE_MAX / size) {
+            errno = ENOMEM;
+            return NULL;
+      }
+
+      size_t total = nmemb * size;
+      if (preload_ready()) {
+            int index = preload_class_of_size(total);
+            if (index >= 0) {
+                  void *block = preload_class_alloc(index);
+                  if (block != NULL) {
+                        memset(block, 0, total);
+                        return block;
+                  }
+            }
+      }
+      return __libc_calloc(nmemb, size);
+}
+
+
+/** Interposed realloc */
+PRELOAD_EXPORT void *realloc(void *ptr, size_t size)
+{
+      if (ptr == NULL) return malloc(size);
+      if (!preload_owns(ptr)) return __libc_realloc(ptr, size);
+
+      if (size == 0) {
+            free(ptr);
+            return NULL;
+      }
+
+      /** Still fits in the current block */
+      size_t class_size = classes[preload_class_of_ptr(ptr)].block_size;
+      if (size <= class_size) return ptr;
+
+      void *block = malloc(size);
+      if (block == NULL) return NULL;
+
+      memcpy(block, ptr, class_size);
+      free(ptr);
+      return block;
+}
+
+
+/** Interposed posix_memalign */
+PRELOAD_EXPORT int posix_memalign(void **memptr, size_t alignment, size_t size)
+{
+      if (alignment < sizeof(void *) || (alignment & (alignment - 1)) != 0) return EINVAL;
+
+      /** Class blocks are aligned to their own size */
+      if (preload_ready()) {
+            int index = preload_class_of_size(size > alignment ? size : alignment);
+            if (index >= 0) {
+                  void *block = preload_class_alloc(index);
+                  if (block != NULL) {
+                        *memptr = block;
+                        return 0;
+                  }
+            }
+      }
+
+      void *block = __libc_memalign(alignment, size);
+      if (block == NULL) return ENOMEM;
+
+      *memptr = block;
+      return 0;
+}
+
+
+/** Interposed malloc_usable_size */
+PRELOAD_EXPORT size_t malloc_usable_size(void *ptr)
+{
+      static size_t (*system_usable_size)(void *) = NULL;
+
+      if (ptr == NULL) return 0;
+      if (preload_owns(ptr)) return classes[preload_class_of_ptr(ptr)].block_size;
+
+      if (system_usable_size == NULL) {
+            system_usable_size = (size_t (*)(void *))dlsym(RTLD_NEXT, "malloc_usable_size");
+            if (system_usable_size == NULL) return 0;
+      }
+      return system_usable_size(ptr);
+}
+
+
+// MIT License
+// 
+// Copyright (c) 2023 João Matos
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
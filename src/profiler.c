@@ -0,0 +1,469 @@
+//
+// Created by JoaoAJMatos on 18-10-2026.
+//
+
+#define _GNU_SOURCE
+
+/** C Includes */
+#include <dlfcn.h>
+#include <errno.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <link.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/** Lib Includes */
+#include <smemory/profiler.h>
+#include "profiler_hooks.h"
+
+
+/** Slot keys besides live pointers */
+#define SLOT_EMPTY ((uintptr_t)0)
+#define SLOT_BUSY  ((uintptr_t)1)
+
+/** Keys are probed in buckets of one cache line */
+#define BUCKET_SLOTS 8
+#define BUCKETS (SMEMORY_PROFILER_SLOTS / BUCKET_SLOTS)
+
+/** Frames skipped at the top of each backtrace (the hook and the allocating function) */
+#define SKIP_FRAMES 2
+
+typedef struct {
+      const char *kind;
+      unsigned int period;        /** Sample period in effect when the sample was taken */
+      int depth;
+      void *frames[SMEMORY_PROFILER_MAX_FRAMES];
+} sample_t;
+
+static _Alignas(64) _Atomic uintptr_t keys[SMEMORY_PROFILER_SLOTS];
+static sample_t samples[SMEMORY_PROFILER_SLOTS];
+static _Atomic unsigned int sample_period = 0;
+static _Atomic unsigned int live_samples = 0;
+
+/**
+ * Counting filter over the sampled keys: a zero counter proves a key was not
+ * sampled, so releasing an unsampled pointer costs one load instead of a
+ * bucket probe even while samples are live
+ */
+#define FILTER_SIZE_LOG2 13
+#define FILTER_SIZE (1 << FILTER_SIZE_LOG2)
+
+/** 16-bit counters cannot overflow: at most SMEMORY_PROFILER_SLOTS keys are live */
+static _Atomic uint16_t filter[FILTER_SIZE];
+static char dump_path[4096];
+
+/** Loaded modules, cached outside signal handlers for signal-safe dumps */
+#define MAX_MODULES 256
+
+typedef struct {
+      uintptr_t base;
+      uintptr_t start;
+      uintptr_t end;
+      char name[128];
+} module_t;
+
+static module_t modules[MAX_MODULES];
+static _Atomic int module_count = 0;
+
+static __thread long countdown = 0;
+static __thread uint64_t rng_state = 0;
+
+
+/** Per-thread xorshift64 generator */
+static uint64_t profiler_random(void)
+{
+      if (rng_state == 0) {
+            /** Threads reusing the same TLS address in the same second still get distinct streams */
+            static _Atomic uint64_t seed_counter = 0;
+            uint64_t seed = atomic_fetch_add_explicit(&seed_counter, 1, memory_order_relaxed) + 1;
+            rng_state = (uint64_t)(uintptr_t)&rng_state ^ (uint64_t)time(NULL) ^ (seed * 0x9e3779b97f4a7c15ULL);
+      }
+
+      rng_state ^= rng_state << 13;
+      rng_state ^= rng_state >> 7;
+      rng_state ^= rng_state << 17;
+      return rng_state;
+}
+
+
+/** Random number of allocations until the next sample */
+static inline long profiler_interval(unsigned int period)
+{
+      return (long)(profiler_random() % (2 * (uint64_t)period - 1)) + 1;
+}
+
+
+/** Sample period if this allocation should be sampled, 0 otherwise */
+static inline unsigned int profiler_should_sample(void)
+{
+      unsigned int period = atomic_load_explicit(&sample_period, memory_order_relaxed);
+      if (period == 0) return 0;
+
+      /**
+       * Intervals are uniform in [1, 2 * period - 1], so samples are one in
+       * period on average. A thread's first interval is drawn the same way,
+       * rather than sampling its first allocation.
+       */
+      if (countdown == 0) countdown = profiler_interval(period);
+      if (--countdown > 0) return 0;
+
+      countdown = profiler_interval(period);
+      return period;
+}
+
+
+/** Hashes a pointer to the first slot of its bucket */
+static inline size_t profiler_bucket(uintptr_t key)
+{
+      key ^= key >> 33;
+      key *= 0xff51afd7ed558ccdULL;
+      key ^= key >> 33;
+      return (size_t)(key % BUCKETS) * BUCKET_SLOTS;
+}
+
+
+/** Filter counter of a key, independent from its bucket */
+static inline _Atomic uint16_t *profiler_filter(uintptr_t key)
+{
+      return &filter[(key * 0x9e3779b97f4a7c15ULL) >> (64 - FILTER_SIZE_LOG2)];
+}
+
+
+/** Whether key may have a live sample */
+static inline int profiler_maybe_sampled(uintptr_t key)
+{
+      return atomic_load_explicit(profiler_filter(key), memory_order_relaxed) != 0;
+}
+
+
+/** Claims a free slot for key and publishes the sample, lock-free */
+static void profiler_insert(uintptr_t key, const char *kind, unsigned int period, void *const *frames, int depth)
+{
+      size_t first = profiler_bucket(key);
+
+      for (size_t i = first; i < first + BUCKET_SLOTS; i++) {
+            uintptr_t expected = SLOT_EMPTY;
+            if (!atomic_compare_exchange_strong(&keys[i], &expected, SLOT_BUSY)) continue;
+
+            samples[i].kind = kind;
+            samples[i].period = period;
+            samples[i].depth = depth;
+            memcpy(samples[i].frames, frames, sizeof(void *) * (size_t)depth);
+
+            atomic_fetch_add_explicit(profiler_filter(key), 1, memory_order_relaxed);
+            atomic_fetch_add_explicit(&live_samples, 1, memory_order_relaxed);
+            atomic_store_explicit(&keys[i], key, memory_order_release);
+            return;
+      }
+
+      /** Bucket full: the sample is dropped */
+}
+
+
+/** Frees the slot holding key, returning whether there was one */
+static int profiler_remove(uintptr_t key, sample_t *copy)
+{
+      size_t first = profiler_bucket(key);
+
+      for (size_t i = first; i < first + BUCKET_SLOTS; i++) {
+            if (atomic_load_explicit(&keys[i], memory_order_acquire) != key) continue;
+
+            if (copy != NULL) *copy = samples[i];
+
+            uintptr_t expected = key;
+            if (!atomic_compare_exchange_strong(&keys[i], &expected, SLOT_EMPTY)) return 0;
+
+            atomic_fetch_sub_explicit(profiler_filter(key), 1, memory_order_relaxed);
+            atomic_fetch_sub_explicit(&live_samples, 1, memory_order_relaxed);
+            return 1;
+      }
+
+      return 0;
+}
+
+
+/** Allocation hook */
+void smemory_profiler_on_alloc(const void *ptr, const char *kind)
+{
+      if (ptr == NULL) return;
+
+      unsigned int period = profiler_should_sample();
+      if (period == 0) return;
+
+      void *frames[SMEMORY_PROFILER_MAX_FRAMES + SKIP_FRAMES];
+      int depth = backtrace(frames, SMEMORY_PROFILER_MAX_FRAMES + SKIP_FRAMES) - SKIP_FRAMES;
+      if (depth <= 0) return;
+
+      profiler_insert((uintptr_t)ptr, kind, period, frames + SKIP_FRAMES, depth);
+}
+
+
+/** Release hook */
+void smemory_profiler_on_release(const void *ptr)
+{
+      if (atomic_load_explicit(&live_samples, memory_order_relaxed) == 0) return;
+      if (!profiler_maybe_sampled((uintptr_t)ptr)) return;
+
+      profiler_remove((uintptr_t)ptr, NULL);
+}
+
+
+/** Move hook */
+void smemory_profiler_on_move(const void *from, const void *to)
+{
+      if (atomic_load_explicit(&live_samples, memory_order_relaxed) == 0) return;
+      if (!profiler_maybe_sampled((uintptr_t)from)) return;
+
+      sample_t sample;
+      if (profiler_remove((uintptr_t)from, &sample)) {
+            profiler_insert((uintptr_t)to, sample.kind, sample.period, sample.frames, sample.depth);
+      }
+}
+
+
+/** Records the address range of one loaded module */
+static int profiler_cache_module(struct dl_phdr_info *info, size_t size, void *data)
+{
+      (void)size;
+      int *count = data;
+      if (*count >= MAX_MODULES) return 1;
+
+      module_t *module = &modules[*count];
+      module->base = (uintptr_t)info->dlpi_addr;
+      module->start = UINTPTR_MAX;
+      module->end = 0;
+
+      for (int i = 0; i < info->dlpi_phnum; i++) {
+            if (info->dlpi_phdr[i].p_type != PT_LOAD) continue;
+
+            uintptr_t start = module->base + (uintptr_t)info->dlpi_phdr[i].p_vaddr;
+            uintptr_t end = start + (uintptr_t)info->dlpi_phdr[i].p_memsz;
+            if (start < module->start) module->start = start;
+            if (end > module->end) module->end = end;
+      }
+      if (module->start >= module->end) return 0;
+
+      /** The main executable has an empty name */
+      const char *name = info->dlpi_name[0] != '\0' ? info->dlpi_name : program_invocation_name;
+      const char *slash = strrchr(name, '/');
+      name = slash != NULL ? slash + 1 : name;
+
+      strncpy(module->name, name, sizeof(module->name) - 1);
+      module->name[sizeof(module->name) - 1] = '\0';
+
+      (*count)++;
+      return 0;
+}
+
+
+/** Refreshes the module cache used by signal-triggered dumps */
+static void profiler_cache_modules(void)
+{
+      int count = 0;
+
+      atomic_store(&module_count, 0);
+      dl_iterate_phdr(profiler_cache_module, &count);
+      atomic_store(&module_count, count);
+}
+
+
+/** Starts sampling */
+int smemory_profiler_start(unsigned int period)
+{
+      if (period == 0) return -1;
+
+      profiler_cache_modules();
+
+      /** backtrace loads the unwinder on first use, do it outside the hooks */
+      void *frame;
+      backtrace(&frame, 1);
+
+      atomic_store(&sample_period, period);
+      return 0;
+}
+
+
+/** Stops sampling */
+void smemory_profiler_stop(void)
+{
+      atomic_store(&sample_period, 0);
+}
+
+
+/** Appends a string to a line buffer, truncating if needed */
+static size_t append_str(char *line, size_t len, size_t cap, const char *str)
+{
+      while (*str != '\0' && len < cap) line[len++] = *str++;
+      return len;
+}
+
+
+/** Appends an unsigned number in the given base */
+static size_t append_num(char *line, size_t len, size_t cap, uintptr_t value, unsigned int base)
+{
+      char digits[2 * sizeof(uintptr_t) + 3];
+      size_t n = sizeof(digits);
+
+      digits[--n] = '\0';
+      do {
+            digits[--n] = "0123456789abcdef"[value % base];
+            value /= base;
+      } while (value != 0);
+
+      if (base == 16) {
+            digits[--n] = 'x';
+            digits[--n] = '0';
+      }
+
+      return append_str(line, len, cap, digits + n);
+}
+
+
+/** Appends a frame as "module+0xoffset" from the module cache, or "0xaddress" */
+static size_t append_raw_frame(char *line, size_t len, size_t cap, void *frame)
+{
+      int count = atomic_load(&module_count);
+
+      for (int i = 0; i < count; i++) {
+            if ((uintptr_t)frame < modules[i].start || (uintptr_t)frame >= modules[i].end) continue;
+
+            len = append_str(line, len, cap, modules[i].name);
+            len = append_str(line, len, cap, "+");
+            return append_num(line, len, cap, (uintptr_t)frame - modules[i].base, 16);
+      }
+
+      return append_num(line, len, cap, (uintptr_t)frame, 16);
+}
+
+
+/** Appends a symbolized frame, "symbol", "module+0xoffset" or "0xaddress" */
+static size_t append_frame(char *line, size_t len, size_t cap, void *frame)
+{
+      Dl_info info;
+
+      if (dladdr(frame, &info) != 0) {
+            if (info.dli_sname != NULL) return append_str(line, len, cap, info.dli_sname);
+
+            if (info.dli_fname != NULL) {
+                  const char *module = strrchr(info.dli_fname, '/');
+                  len = append_str(line, len, cap, module != NULL ? module + 1 : info.dli_fname);
+                  len = append_str(line, len, cap, "+");
+                  return append_num(line, len, cap, (uintptr_t)frame - (uintptr_t)info.dli_fbase, 16);
+            }
+      }
+
+      return append_num(line, len, cap, (uintptr_t)frame, 16);
+}
+
+
+/** Writes every live sample as a folded stack line */
+static int profiler_dump(int fd, int symbolize)
+{
+      char line[4096];
+      sample_t sample;
+      int written = 0;
+
+      for (size_t i = 0; i < SMEMORY_PROFILER_SLOTS; i++) {
+            uintptr_t key = atomic_load_explicit(&keys[i], memory_order_acquire);
+            if (key == SLOT_EMPTY || key == SLOT_BUSY) continue;
+
+            sample = samples[i];
+
+            /** Skip samples released or reused while being copied */
+            if (atomic_load_explicit(&keys[i], memory_order_acquire) != key) continue;
+
+            /** Folded stacks go from the root to the leaf */
+            size_t len = 0;
+            size_t cap = sizeof(line) - 32;
+            for (int frame = sample.depth - 1; frame >= 0; frame--) {
+                  len = symbolize ? append_frame(line, len, cap, sample.frames[frame])
+                                  : append_raw_frame(line, len, cap, sample.frames[frame]);
+                  len = append_str(line, len, cap, ";");
+            }
+            len = append_str(line, len, cap, "[");
+            len = append_str(line, len, cap, sample.kind);
+            len = append_str(line, len, cap, "] ");
+            len = append_num(line, len, sizeof(line) - 1, sample.period, 10);
+            line[len++] = '\n';
+
+            for (size_t off = 0; off < len; ) {
+                  ssize_t n = write(fd, line + off, len - off);
+                  if (n < 0 && errno == EINTR) continue;
+                  if (n <= 0) return -1;
+                  off += (size_t)n;
+            }
+            written++;
+      }
+
+      return written;
+}
+
+
+/** Writes every live sample, with symbol names */
+int smemory_profiler_dump(int fd)
+{
+      return profiler_dump(fd, 1);
+}
+
+
+/** Signal handler writing a dump to dump_path, without symbol lookups */
+static void profiler_signal_handler(int signum)
+{
+      (void)signum;
+      int saved_errno = errno;
+
+      int fd = open(dump_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+      if (fd >= 0) {
+            profiler_dump(fd, 0);
+            close(fd);
+      }
+
+      errno = saved_errno;
+}
+
+
+/** Installs the dump signal handler */
+int smemory_profiler_dump_on_signal(int signum, const char *path)
+{
+      if (path == NULL || strlen(path) >= sizeof(dump_path)) return -1;
+      strcpy(dump_path, path);
+
+      profiler_cache_modules();
+
+      struct sigaction action;
+      memset(&action, 0, sizeof(action));
+      action.sa_handler = profiler_signal_handler;
+      action.sa_flags = SA_RESTART;
+      sigemptyset(&action.sa_mask);
+
+      return sigaction(signum, &action, NULL);
+}
+
+
+
+// MIT License
+// 
+// Copyright (c) 2023 João Matos
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
@@ -0,0 +1,31 @@
+//
+// Created by JoaoAJMatos on 18-10-2026.
+//
+// Description: Hooks the allocation functions use to report to the sampling
+//              profiler. Not part of the public API.
+//
+
+#ifndef SMEMORY_PROFILER_HOOKS_H
+#define SMEMORY_PROFILER_HOOKS_H
+
+#ifndef SMEMORY_NO_PROFILER
+
+/** Possibly samples a new allocation identified by ptr */
+void smemory_profiler_on_alloc(const void *ptr, const char *kind);
+
+/** Drops the sample of ptr, if any */
+void smemory_profiler_on_release(const void *ptr);
+
+/** Moves the sample of from, if any, to the new address to */
+void smemory_profiler_on_move(const void *from, const void *to);
+
+#else
+
+/** Builds without the profiler (e.g. the preload shim) compile the hooks out */
+#define smemory_profiler_on_alloc(ptr, kind) ((void)0)
+#define smemory_profiler_on_release(ptr)     ((void)0)
+#define smemory_profiler_on_move(from, to)   ((void)0)
+
+#endif //SMEMORY_NO_PROFILER
+
+#endif //SMEMORY_PROFILER_HOOKS_H
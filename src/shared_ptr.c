@@ -8,6 +8,7 @@
 
 /** Lib Includes */
 #include <smemory/shared_ptr.h>
+#include "profiler_hooks.h"
 
 
 /** Constructs a new shared_ptr */
@@ -15,9 +16,30 @@ shared_ptr_t *shared_ptr_make(void *ptr, destructor_t destructor)
 {
       shared_ptr_t *_shared_ptr = malloc(sizeof(shared_ptr_t));
       _shared_ptr->ptr = ptr;
+      _shared_ptr->managed = ptr;
       _shared_ptr->destructor = destructor;
       _shared_ptr->ref_count = malloc(sizeof(int));
       *_shared_ptr->ref_count = 1;
+      smemory_profiler_on_alloc(_shared_ptr, "shared_ptr_make");
+      return _shared_ptr;
+}
+
+
+/** Constructs a shared_ptr sharing ownership with owner but pointing at ptr */
+shared_ptr_t *shared_ptr_alias(shared_ptr_t *owner, void *ptr)
+{
+      if (owner == NULL) return NULL;
+
+      shared_ptr_t *_shared_ptr = malloc(sizeof(shared_ptr_t));
+      if (_shared_ptr == NULL) return NULL;
+
+      _shared_ptr->ptr = ptr;
+      _shared_ptr->managed = owner->managed;
+      _shared_ptr->destructor = owner->destructor;
+      _shared_ptr->ref_count = owner->ref_count;
+      shared_ptr_increment_ref_count(owner);
+
+      smemory_profiler_on_alloc(_shared_ptr, "shared_ptr_alias");
       return _shared_ptr;
 }
 
@@ -31,10 +53,12 @@ shared_ptr_t *shared_ptr_copy(shared_ptr_t *source)
       if (_shared_ptr == NULL) return NULL;
 
       _shared_ptr->ptr = source->ptr;
+      _shared_ptr->managed = source->managed;
       _shared_ptr->destructor = source->destructor;
       _shared_ptr->ref_count = source->ref_count;
       shared_ptr_increment_ref_count(source);
 
+      smemory_profiler_on_alloc(_shared_ptr, "shared_ptr_copy");
       return _shared_ptr;
 }
 
@@ -48,9 +72,11 @@ shared_ptr_t *shared_ptr_move(shared_ptr_t *ptr)
       if (_shared_ptr == NULL) return NULL;
 
       _shared_ptr->ptr = ptr->ptr;
+      _shared_ptr->managed = ptr->managed;
       _shared_ptr->destructor = ptr->destructor;
       _shared_ptr->ref_count = ptr->ref_count;
 
+      smemory_profiler_on_move(ptr, _shared_ptr);
       free(ptr);
       return _shared_ptr;
 }
@@ -62,16 +88,17 @@ void shared_ptr_destroy(shared_ptr_t **ptr)
       if (ptr == NULL) return;
       if (*ptr == NULL) return;
 
-      shared_ptr_decrement_ref_count(*ptr);
-
-      if (shared_ptr_get_ref_count(*ptr) <= 0) {
+      /** The last owner releases the managed object and the reference count */
+      if (__atomic_sub_fetch((*ptr)->ref_count, 1, __ATOMIC_ACQ_REL) <= 0) {
             if ((*ptr)->destructor != NULL) {
-                  ((*ptr)->destructor)((*ptr)->ptr);
+                  ((*ptr)->destructor)((*ptr)->managed);
             }
             free((*ptr)->ref_count);
-            free(*ptr);
-            *ptr = NULL;
       }
+
+      smemory_profiler_on_release(*ptr);
+      free(*ptr);
+      *ptr = NULL;
 }
 
 
@@ -87,21 +114,21 @@ void *shared_ptr_get(shared_ptr_t *ptr)
 inline int shared_ptr_get_ref_count(shared_ptr_t *ptr)
 {
       if (ptr == NULL) return -1;
-      return *ptr->ref_count;
+      return __atomic_load_n(ptr->ref_count, __ATOMIC_ACQUIRE);
 }
 
 /** Increments the ref count of a shared_ptr */
 inline void shared_ptr_increment_ref_count(shared_ptr_t *ptr)
 {
       if (ptr == NULL) return;
-      *ptr->ref_count++;
+      __atomic_add_fetch(ptr->ref_count, 1, __ATOMIC_RELAXED);
 }
 
 /** Decrements the ref count of a shared_ptr */
 void shared_ptr_decrement_ref_count(shared_ptr_t *ptr)
 {
       if (ptr == NULL) return;
-      *ptr->ref_count--;
+      __atomic_sub_fetch(ptr->ref_count, 1, __ATOMIC_ACQ_REL);
 }
 
 
@@ -0,0 +1,400 @@
+//
+// Created by JoaoAJMatos on 18-10-2026.
+//
+
+#define _DEFAULT_SOURCE
+
+/** C Includes */
+#include <stddef.h>
+#include <sys/mman.h>
+
+/** Lib Includes */
+#include <smemory/tlsf.h>
+
+
+/** Block granularity and payload alignment */
+#define ALIGN_SIZE_LOG2 4
+#define ALIGN_SIZE      ((size_t)1 << ALIGN_SIZE_LOG2)
+
+/** Sizes below this are spread linearly over the first level 0 */
+#define FL_INDEX_SHIFT   (TLSF_SL_INDEX_COUNT_LOG2 + ALIGN_SIZE_LOG2)
+#define SMALL_BLOCK_SIZE ((size_t)1 << FL_INDEX_SHIFT)
+
+#define BLOCK_SIZE_MAX   (((size_t)1 << (TLSF_FL_INDEX_COUNT + FL_INDEX_SHIFT - 1)) - ALIGN_SIZE)
+
+#define BLOCK_FREE_BIT   ((size_t)1)
+
+
+/**
+ * Every block starts with a header, immediately followed by its payload. The
+ * free list links are only meaningful while the block is free, and live in
+ * what would otherwise be the payload. The region ends with a zero-sized used
+ * sentinel so coalescing never walks past it.
+ */
+typedef struct tlsf_block {
+      struct tlsf_block *prev_phys;
+      size_t size;
+      struct tlsf_block *next_free;
+      struct tlsf_block *prev_free;
+} tlsf_block_t;
+
+#define BLOCK_HEADER_SIZE offsetof(tlsf_block_t, next_free)
+#define BLOCK_SIZE_MIN    (sizeof(tlsf_block_t) - BLOCK_HEADER_SIZE)
+
+
+/** Block helpers */
+static inline size_t block_size(const tlsf_block_t *block)
+{
+      return block->size & ~BLOCK_FREE_BIT;
+}
+
+static inline int block_is_free(const tlsf_block_t *block)
+{
+      return (block->size & BLOCK_FREE_BIT) != 0;
+}
+
+static inline void *block_to_ptr(tlsf_block_t *block)
+{
+      return (char *)block + BLOCK_HEADER_SIZE;
+}
+
+static inline tlsf_block_t *block_from_ptr(void *ptr)
+{
+      return (tlsf_block_t *)((char *)ptr - BLOCK_HEADER_SIZE);
+}
+
+static inline tlsf_block_t *block_next(tlsf_block_t *block)
+{
+      return (tlsf_block_t *)((char *)block_to_ptr(block) + block_size(block));
+}
+
+
+/** Index of the most significant set bit */
+static inline int fls_size(size_t size)
+{
+      return (int)(sizeof(unsigned long long) * 8) - 1 - __builtin_clzll((unsigned long long)size);
+}
+
+
+/** Maps a block size to the list holding blocks of that size */
+static inline void mapping_insert(size_t size, int *fl, int *sl)
+{
+      if (size < SMALL_BLOCK_SIZE) {
+            *fl = 0;
+            *sl = (int)(size / (SMALL_BLOCK_SIZE / TLSF_SL_INDEX_COUNT));
+      } else {
+            int bit = fls_size(size);
+            *sl = (int)(size >> (bit - TLSF_SL_INDEX_COUNT_LOG2)) ^ TLSF_SL_INDEX_COUNT;
+            *fl = bit - (FL_INDEX_SHIFT - 1);
+      }
+}
+
+
+/** Smallest block size stored in list (fl, sl) */
+static inline size_t list_min_size(int fl, int sl)
+{
+      if (fl == 0) return (size_t)sl * (SMALL_BLOCK_SIZE / TLSF_SL_INDEX_COUNT);
+
+      size_t base = (size_t)1 << (fl + FL_INDEX_SHIFT - 1);
+      return base + (size_t)sl * (base >> TLSF_SL_INDEX_COUNT_LOG2);
+}
+
+
+/** Maps a request to the first list whose blocks are all large enough */
+static inline void mapping_search(size_t size, int *fl, int *sl)
+{
+      if (size >= SMALL_BLOCK_SIZE) {
+            size += ((size_t)1 << (fls_size(size) - TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+      }
+      mapping_insert(size, fl, sl);
+}
+
+
+/** Finds a non-empty list at or above (fl, sl) using the bitmaps */
+static tlsf_block_t *search_suitable_block(tlsf_t *tlsf, int *fl, int *sl)
+{
+      if (*fl >= TLSF_FL_INDEX_COUNT) return NULL;
+
+      uint32_t sl_map = tlsf->sl_bitmap[*fl] & (~0U << *sl);
+      if (sl_map == 0) {
+            if (*fl + 1 >= TLSF_FL_INDEX_COUNT) return NULL;
+
+            uint32_t fl_map = tlsf->fl_bitmap & (~0U << (*fl + 1));
+            if (fl_map == 0) return NULL;
+
+            *fl = __builtin_ctz(fl_map);
+            sl_map = tlsf->sl_bitmap[*fl];
+      }
+
+      *sl = __builtin_ctz(sl_map);
+      return tlsf->blocks[*fl][*sl];
+}
+
+
+/** Links a free block into its list */
+static void insert_free_block(tlsf_t *tlsf, tlsf_block_t *block)
+{
+      int fl, sl;
+      mapping_insert(block_size(block), &fl, &sl);
+
+      tlsf_block_t *head = tlsf->blocks[fl][sl];
+      block->next_free = head;
+      block->prev_free = NULL;
+      if (head != NULL) head->prev_free = block;
+
+      tlsf->blocks[fl][sl] = block;
+      tlsf->fl_bitmap |= 1U << fl;
+      tlsf->sl_bitmap[fl] |= 1U << sl;
+
+      block->size |= BLOCK_FREE_BIT;
+      tlsf->free_size += block_size(block);
+      tlsf->free_count++;
+}
+
+
+/** Unlinks a free block from its list */
+static void remove_free_block(tlsf_t *tlsf, tlsf_block_t *block)
+{
+      int fl, sl;
+      mapping_insert(block_size(block), &fl, &sl);
+
+      if (block->prev_free != NULL) block->prev_free->next_free = block->next_free;
+      if (block->next_free != NULL) block->next_free->prev_free = block->prev_free;
+
+      if (tlsf->blocks[fl][sl] == block) {
+            tlsf->blocks[fl][sl] = block->next_free;
+            if (block->next_free == NULL) {
+                  tlsf->sl_bitmap[fl] &= ~(1U << sl);
+                  if (tlsf->sl_bitmap[fl] == 0) tlsf->fl_bitmap &= ~(1U << fl);
+            }
+      }
+
+      block->size &= ~BLOCK_FREE_BIT;
+      tlsf->free_size -= block_size(block);
+      tlsf->free_count--;
+}
+
+
+/** Splits off whatever block does not need and returns it to the free lists */
+static void trim_block(tlsf_t *tlsf, tlsf_block_t *block, size_t size)
+{
+      if (block_size(block) < size + BLOCK_HEADER_SIZE + BLOCK_SIZE_MIN) return;
+
+      tlsf_block_t *remainder = (tlsf_block_t *)((char *)block_to_ptr(block) + size);
+      remainder->prev_phys = block;
+      remainder->size = block_size(block) - size - BLOCK_HEADER_SIZE;
+      block->size = size | (block->size & BLOCK_FREE_BIT);
+      block_next(remainder)->prev_phys = remainder;
+
+      insert_free_block(tlsf, remainder);
+}
+
+
+/** Absorbs the block following block, both already out of the free lists */
+static void merge_next(tlsf_block_t *block)
+{
+      tlsf_block_t *next = block_next(block);
+      block->size += BLOCK_HEADER_SIZE + block_size(next);
+      block_next(block)->prev_phys = block;
+}
+
+
+/** Inits a TLSF allocator */
+int tlsf_init(tlsf_t* tlsf, void* memory, size_t size)
+{
+      tlsf->owns_memory = 0;
+
+      if (memory == NULL) {
+            /** Prefault, and lock if allowed, so no page fault hits alloc or free */
+            memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+            if (memory == MAP_FAILED) return -1;
+            mlock(memory, size);
+            tlsf->owns_memory = 1;
+      }
+
+      tlsf->memory = memory;
+      tlsf->size = size;
+
+      /** Align the usable part of the region */
+      uintptr_t start = ((uintptr_t)memory + ALIGN_SIZE - 1) & ~(uintptr_t)(ALIGN_SIZE - 1);
+      uintptr_t end = ((uintptr_t)memory + size) & ~(uintptr_t)(ALIGN_SIZE - 1);
+
+      if (end <= start || end - start < 2 * BLOCK_HEADER_SIZE + BLOCK_SIZE_MIN
+          || end - start - 2 * BLOCK_HEADER_SIZE > BLOCK_SIZE_MAX) {
+            if (tlsf->owns_memory) munmap(memory, size);
+            return -1;
+      }
+
+      tlsf->fl_bitmap = 0;
+      for (int fl = 0; fl < TLSF_FL_INDEX_COUNT; fl++) {
+            tlsf->sl_bitmap[fl] = 0;
+            for (int sl = 0; sl < TLSF_SL_INDEX_COUNT; sl++) {
+                  tlsf->blocks[fl][sl] = NULL;
+            }
+      }
+
+      tlsf->used_size = 0;
+      tlsf->used_count = 0;
+      tlsf->peak_used_size = 0;
+      tlsf->free_size = 0;
+      tlsf->free_count = 0;
+
+      /** One free block spanning the region, followed by the sentinel */
+      tlsf_block_t *block = (tlsf_block_t *)start;
+      block->prev_phys = NULL;
+      block->size = end - start - 2 * BLOCK_HEADER_SIZE;
+
+      tlsf_block_t *sentinel = block_next(block);
+      sentinel->prev_phys = block;
+      sentinel->size = 0;
+
+      insert_free_block(tlsf, block);
+
+      /** Priority inheritance bounds how long a real-time thread can wait on the lock */
+      pthread_mutexattr_t attr;
+      pthread_mutexattr_init(&attr);
+      pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+      pthread_mutex_init(&tlsf->mutex, &attr);
+      pthread_mutexattr_destroy(&attr);
+      return 0;
+}
+
+
+/** Destroys a TLSF allocator */
+void tlsf_destroy(tlsf_t* tlsf)
+{
+      if (tlsf->owns_memory) {
+            munlock(tlsf->memory, tlsf->size);
+            munmap(tlsf->memory, tlsf->size);
+      }
+
+      tlsf->memory = NULL;
+      pthread_mutex_destroy(&tlsf->mutex);
+}
+
+
+/** Allocates a block */
+void* tlsf_alloc(tlsf_t* tlsf, size_t size)
+{
+      if (size == 0 || size > BLOCK_SIZE_MAX) return NULL;
+
+      size = (size + ALIGN_SIZE - 1) & ~(ALIGN_SIZE - 1);
+      if (size < BLOCK_SIZE_MIN) size = BLOCK_SIZE_MIN;
+
+      int fl, sl;
+      mapping_search(size, &fl, &sl);
+
+      pthread_mutex_lock(&tlsf->mutex);
+
+      tlsf_block_t *block = search_suitable_block(tlsf, &fl, &sl);
+      if (block == NULL) {
+            pthread_mutex_unlock(&tlsf->mutex);
+            return NULL;
+      }
+
+      remove_free_block(tlsf, block);
+      trim_block(tlsf, block, size);
+
+      tlsf->used_size += block_size(block);
+      tlsf->used_count++;
+      if (tlsf->used_size > tlsf->peak_used_size) tlsf->peak_used_size = tlsf->used_size;
+
+      pthread_mutex_unlock(&tlsf->mutex);
+      return block_to_ptr(block);
+}
+
+
+/** Frees a block, coalescing it with its free neighbours */
+void tlsf_free(tlsf_t* tlsf, void* ptr)
+{
+      if (ptr == NULL) return;
+
+      tlsf_block_t *block = block_from_ptr(ptr);
+
+      pthread_mutex_lock(&tlsf->mutex);
+
+      tlsf->used_size -= block_size(block);
+      tlsf->used_count--;
+
+      tlsf_block_t *next = block_next(block);
+      if (block_is_free(next)) {
+            remove_free_block(tlsf, next);
+            merge_next(block);
+      }
+
+      tlsf_block_t *prev = block->prev_phys;
+      if (prev != NULL && block_is_free(prev)) {
+            remove_free_block(tlsf, prev);
+            merge_next(prev);
+            block = prev;
+      }
+
+      insert_free_block(tlsf, block);
+
+      pthread_mutex_unlock(&tlsf->mutex);
+}
+
+
+/** Usable size of an allocated block */
+size_t tlsf_block_size(void* ptr)
+{
+      if (ptr == NULL) return 0;
+      return block_size(block_from_ptr(ptr));
+}
+
+
+/** Fills in the allocator statistics */
+void tlsf_get_stats(tlsf_t* tlsf, tlsf_stats_t* stats)
+{
+      pthread_mutex_lock(&tlsf->mutex);
+
+      stats->total_size = tlsf->size;
+      stats->used_size = tlsf->used_size;
+      stats->used_count = tlsf->used_count;
+      stats->peak_used_size = tlsf->peak_used_size;
+      stats->free_size = tlsf->free_size;
+      stats->free_count = tlsf->free_count;
+      stats->max_alloc_size = 0;
+
+      /** Only the bitmaps are read: walking a free list would not be O(1) */
+      if (tlsf->fl_bitmap != 0) {
+            int fl = 31 - __builtin_clz(tlsf->fl_bitmap);
+            int sl = 31 - __builtin_clz(tlsf->sl_bitmap[fl]);
+
+            /**
+             * mapping_search rounds requests up to the next list, so only
+             * requests up to the lower bound of that list are served
+             */
+            stats->max_alloc_size = list_min_size(fl, sl);
+      }
+
+      pthread_mutex_unlock(&tlsf->mutex);
+
+      stats->fragmentation = stats->free_size == 0
+                             ? 0.0
+                             : 1.0 - (double)stats->max_alloc_size / (double)stats->free_size;
+}
+
+
+
+// MIT License
+// 
+// Copyright (c) 2023 João Matos
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
@@ -8,6 +8,7 @@
 
 /** Lib Includes */
 #include <smemory/unique_ptr.h>
+#include "profiler_hooks.h"
 
 
 /** Constructs a new unique_ptr */
@@ -16,6 +17,7 @@ unique_ptr_t *unique_ptr_make(void *ptr, destructor_t destructor)
       unique_ptr_t *_unique_ptr = malloc(sizeof(unique_ptr_t));
       _unique_ptr->ptr = ptr;
       _unique_ptr->destructor = destructor;
+      smemory_profiler_on_alloc(_unique_ptr, "unique_ptr_make");
       return _unique_ptr;
 }
 
@@ -32,6 +34,7 @@ unique_ptr_t *unique_ptr_move(unique_ptr_t **source)
       _unique_ptr->ptr = (*source)->ptr;
       _unique_ptr->destructor = (*source)->destructor;
 
+      smemory_profiler_on_move(*source, _unique_ptr);
       free(*source);
       *source = NULL;
 
@@ -49,6 +52,7 @@ void unique_ptr_destroy(unique_ptr_t **ptr)
             (*ptr)->destructor((*ptr)->ptr);
       }
 
+      smemory_profiler_on_release(*ptr);
       free(*ptr);
       *ptr = NULL;
 }